@@ -0,0 +1,639 @@
+Benchmarking the Week 4 Algorithms
+Goal: Measure every STL algorithm and design pattern from Tasks 1-5 on HMI control lists from 10 to 10^7 entries.
+Scenario:
+Before optimizing the HMI code paths, the team needs repeatable numbers for each operation at realistic and extreme list sizes.
+Steps:
+Runner:
+Run each benchmark once untimed as a warm-up, then five timed repetitions of at least 20 ms and two iterations each, and report the median repetition; per-iteration setup is kept out of the measurement with pause/resume.
+Counters:
+Report nanoseconds per operation, heap allocations per operation (counted by replacing operator new) and hardware cache misses per operation (read through perf_event; shown as n/a when the kernel does not allow it).
+Coverage:
+Task 1 for_each, find_if, adjacent_find, count_if and equal; the Task 3 transform/replace/remove_if/reverse/partition chain; Task 4 sort, merge and set_union/set_intersection; Task 5 factory creation, observer notification and strategy rendering (console output is sent to a null buffer).
+The Task files are standalone programs, so each case times a copy of that Task's code path kept in this file; a change to a Task must be mirrored here to show up in the numbers.
+Output:
+Print a table and write the same results as Google Benchmark-style JSON, so runs can be compared or plotted.
+Usage: week4_benchmarks [max_range (10..10000000, default 10000000)] [json_path] [name_filter]
+Program:
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <set>
+#include <string>
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <functional>
+#include <chrono>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <iomanip>
+#include <stdexcept>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+using namespace std;
+// Every heap allocation in the process goes through these, so the runner can report allocations per op.
+atomic<uint64_t> allocationCount(0);
+// noinline keeps GCC from seeing malloc/free through the replacements and warning about a mismatch.
+__attribute__((noinline)) void* operator new(size_t size)
+{
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    if (void* memory = malloc(size == 0 ? 1 : size))
+    {
+        return memory;
+    }
+    throw bad_alloc();
+}
+__attribute__((noinline)) void operator delete(void* memory) noexcept
+{
+    free(memory);
+}
+__attribute__((noinline)) void operator delete(void* memory, size_t) noexcept
+{
+    free(memory);
+}
+// Hardware cache-miss counter for the calling thread; reports unavailable when perf_event is not permitted.
+class CacheMissCounter 
+{
+    private:
+        int fd = -1;
+    public:
+        CacheMissCounter()
+        {
+            perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            if (fd >= 0)
+            {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+        CacheMissCounter(const CacheMissCounter&) = delete;
+        CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+        ~CacheMissCounter()
+        {
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+        }
+        bool available() const
+        {
+            return fd >= 0;
+        }
+        uint64_t read() const
+        {
+            uint64_t value = 0;
+            if (fd >= 0 && ::read(fd, &value, sizeof(value)) != sizeof(value))
+            {
+                value = 0;
+            }
+            return value;
+        }
+};
+// Loop driver in the style of benchmark::State: the body calls keepRunning() once per iteration and
+// may bracket per-iteration setup with pause()/resume() to keep it out of every measurement. A run
+// ends once it has both reached the minimum time and done the minimum number of iterations.
+class BenchmarkState 
+{
+    private:
+        size_t n;
+        const CacheMissCounter& misses;
+        double minTimeNs;
+        uint64_t minIterations;
+        uint64_t iterations = 0;
+        bool running = false;
+        chrono::steady_clock::time_point segmentStart;
+        uint64_t segmentAllocations = 0;
+        uint64_t segmentMisses = 0;
+        double elapsedNs = 0;
+        uint64_t allocations = 0;
+        uint64_t cacheMisses = 0;
+    public:
+        BenchmarkState(size_t range, const CacheMissCounter& counter, double minTimeSeconds, uint64_t minIters = 1) : n(range), misses(counter), minTimeNs(minTimeSeconds * 1e9), minIterations(minIters) {}
+        size_t range() const
+        {
+            return n;
+        }
+        void resume()
+        {
+            segmentAllocations = allocationCount.load(memory_order_relaxed);
+            segmentMisses = misses.read();
+            segmentStart = chrono::steady_clock::now();
+        }
+        void pause()
+        {
+            auto now = chrono::steady_clock::now();
+            elapsedNs += chrono::duration<double, nano>(now - segmentStart).count();
+            allocations += allocationCount.load(memory_order_relaxed) - segmentAllocations;
+            cacheMisses += misses.read() - segmentMisses;
+        }
+        bool keepRunning()
+        {
+            if (!running)
+            {
+                running = true;
+                resume();
+                return true;
+            }
+            ++iterations;
+            pause();
+            if ((elapsedNs >= minTimeNs && iterations >= minIterations) || iterations >= 1000000)
+            {
+                return false;
+            }
+            resume();
+            return true;
+        }
+        uint64_t iterationCount() const
+        {
+            return iterations;
+        }
+        double nsPerOp() const
+        {
+            return elapsedNs / iterations;
+        }
+        double allocationsPerOp() const
+        {
+            return static_cast<double>(allocations) / iterations;
+        }
+        double cacheMissesPerOp() const
+        {
+            return static_cast<double>(cacheMisses) / iterations;
+        }
+};
+struct BenchmarkCase 
+{
+    string name;
+    function<void(BenchmarkState&)> body;
+};
+struct BenchmarkResult 
+{
+    string name;
+    size_t range;
+    uint64_t iterations;
+    double nsPerOp;
+    double allocationsPerOp;
+    double cacheMissesPerOp;
+};
+volatile size_t benchmarkSink = 0;
+class NullBuffer : public streambuf 
+{
+    protected:
+        int overflow(int c) override
+        {
+            return c;
+        }
+};
+// Task1 data: the original Control with string type/state.
+struct Control 
+{
+    int id;
+    string type;
+    string state;
+};
+vector<Control> makeControls(size_t n)
+{
+    const char* states[] = {"visible", "invisible", "disabled"};
+    vector<Control> controls;
+    controls.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        controls.push_back({static_cast<int>(i + 1), i < n / 2 ? "button" : "slider", states[i % 3]});
+    }
+    return controls;
+}
+// Task3 data: the original list of state strings.
+vector<string> makeStates(size_t n)
+{
+    const char* states[] = {"Slider1", "visible", "invisible", "disabled", "Button1"};
+    vector<string> controls;
+    controls.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        controls.push_back(states[(i * 7) % 5]);
+    }
+    return controls;
+}
+// Task4 data: string-ID controls ordered by ID.
+struct CatalogControl 
+{
+    string id;
+    string type;
+    bool operator<(const CatalogControl& other) const 
+    {
+        return id < other.id;
+    }
+};
+vector<CatalogControl> makeCatalog(size_t n, uint32_t seed)
+{
+    vector<CatalogControl> controls;
+    controls.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        controls.push_back({"C" + to_string(seed % (n * 2 + 1)), i % 2 ? "Slider" : "Button"});
+    }
+    return controls;
+}
+// Task5 types, unchanged in shape: virtual render/update writing to cout with endl.
+class Widget 
+{
+    public:
+        virtual void render() = 0;
+        virtual ~Widget() = default;
+};
+class Button : public Widget 
+{
+    public:
+        void render() override 
+        {
+            cout << "Rendering Button" << endl;
+        }
+};
+class Slider : public Widget 
+{
+    public:
+        void render() override 
+        {
+            cout << "Rendering Slider" << endl;
+        }
+};
+shared_ptr<Widget> createControl(bool slider)
+{
+    return slider ? shared_ptr<Widget>(make_shared<Slider>()) : shared_ptr<Widget>(make_shared<Button>());
+}
+class ModeObserver 
+{
+    public:
+        virtual void update(const string& mode) = 0;
+        virtual ~ModeObserver() = default;
+};
+class ButtonObserver : public ModeObserver 
+{
+    public:
+        void update(const string& mode) override 
+        {
+            cout << (mode == "Night" ? "Button: Adjusting visibility for Night mode." : "Button: Adjusting visibility for Day mode.") << endl;
+        }
+};
+class RenderStrategy 
+{
+    public:
+        virtual void render() = 0;
+        virtual ~RenderStrategy() = default;
+};
+class Render2D : public RenderStrategy 
+{
+    public:
+        void render() override 
+        {
+            cout << "Rendering in 2D" << endl;
+        }
+};
+vector<BenchmarkCase> task1Cases()
+{
+    return {
+        {"Task1/for_each", [](BenchmarkState& state)
+        {
+            auto controls = makeControls(state.range());
+            while (state.keepRunning())
+            {
+                size_t total = 0;
+                for_each(controls.begin(), controls.end(), [&total](const Control& c) { total += c.id + c.state.size(); });
+                benchmarkSink = total;
+            }
+        }},
+        {"Task1/find_if", [](BenchmarkState& state)
+        {
+            auto controls = makeControls(state.range());
+            int searchID = static_cast<int>(state.range());
+            while (state.keepRunning())
+            {
+                benchmarkSink = find_if(controls.begin(), controls.end(), [searchID](const Control& c) { return c.id == searchID; }) - controls.begin();
+            }
+        }},
+        {"Task1/adjacent_find", [](BenchmarkState& state)
+        {
+            auto controls = makeControls(state.range());
+            while (state.keepRunning())
+            {
+                benchmarkSink = adjacent_find(controls.begin(), controls.end(), [](const Control& a, const Control& b) { return a.state == b.state; }) - controls.begin();
+            }
+        }},
+        {"Task1/count_if", [](BenchmarkState& state)
+        {
+            auto controls = makeControls(state.range());
+            while (state.keepRunning())
+            {
+                benchmarkSink = count_if(controls.begin(), controls.end(), [](const Control& c) { return c.type == "slider" && c.state == "disabled"; });
+            }
+        }},
+        {"Task1/equal", [](BenchmarkState& state)
+        {
+            auto controls = makeControls(state.range());
+            auto other = controls;
+            while (state.keepRunning())
+            {
+                benchmarkSink = equal(controls.begin(), controls.end(), other.begin(), [](const Control& a, const Control& b) { return a.type == b.type && a.state == b.state; });
+            }
+        }},
+    };
+}
+vector<BenchmarkCase> task3Cases()
+{
+    return {
+        {"Task3/transform_remove_partition", [](BenchmarkState& state)
+        {
+            auto original = makeStates(state.range());
+            vector<string> controls;
+            while (state.keepRunning())
+            {
+                state.pause();
+                controls = original;
+                state.resume();
+                transform(controls.begin(), controls.end(), controls.begin(), [](string& s) { return s.find("Slider") != string::npos ? "invisible" : s; });
+                replace(controls.begin(), controls.end(), string("disabled"), string("enabled"));
+                controls.erase(remove_if(controls.begin(), controls.end(), [](const string& s) { return s == "invisible"; }), controls.end());
+                reverse(controls.begin(), controls.end());
+                benchmarkSink = partition(controls.begin(), controls.end(), [](const string& s) { return s == "visible"; }) - controls.begin();
+            }
+        }},
+    };
+}
+vector<BenchmarkCase> task4Cases()
+{
+    return {
+        {"Task4/sort", [](BenchmarkState& state)
+        {
+            auto original = makeCatalog(state.range(), 1);
+            vector<CatalogControl> controls;
+            while (state.keepRunning())
+            {
+                state.pause();
+                controls = original;
+                state.resume();
+                sort(controls.begin(), controls.end());
+                benchmarkSink = controls.size();
+            }
+        }},
+        {"Task4/merge", [](BenchmarkState& state)
+        {
+            auto first = makeCatalog(state.range() / 2, 2);
+            auto second = makeCatalog(state.range() - state.range() / 2, 3);
+            sort(first.begin(), first.end());
+            sort(second.begin(), second.end());
+            while (state.keepRunning())
+            {
+                vector<CatalogControl> merged(first.size() + second.size());
+                merge(first.begin(), first.end(), second.begin(), second.end(), merged.begin());
+                benchmarkSink = merged.size();
+            }
+        }},
+        {"Task4/set_union_intersection", [](BenchmarkState& state)
+        {
+            auto first = makeCatalog(state.range() / 2, 4);
+            auto second = makeCatalog(state.range() - state.range() / 2, 5);
+            while (state.keepRunning())
+            {
+                set<CatalogControl> set1(first.begin(), first.end());
+                set<CatalogControl> set2(second.begin(), second.end());
+                vector<CatalogControl> unionControls;
+                vector<CatalogControl> intersectionControls;
+                set_union(set1.begin(), set1.end(), set2.begin(), set2.end(), back_inserter(unionControls));
+                set_intersection(set1.begin(), set1.end(), set2.begin(), set2.end(), back_inserter(intersectionControls));
+                benchmarkSink = unionControls.size() + intersectionControls.size();
+            }
+        }},
+    };
+}
+vector<BenchmarkCase> task5Cases()
+{
+    return {
+        {"Task5/factory", [](BenchmarkState& state)
+        {
+            while (state.keepRunning())
+            {
+                vector<shared_ptr<Widget>> controls;
+                controls.reserve(state.range());
+                for (size_t i = 0; i < state.range(); ++i)
+                {
+                    controls.push_back(createControl(i % 2 == 1));
+                }
+                benchmarkSink = controls.size();
+            }
+        }},
+        {"Task5/observer", [](BenchmarkState& state)
+        {
+            vector<ButtonObserver> storage(state.range());
+            vector<ModeObserver*> observers;
+            for (auto& observer : storage)
+            {
+                observers.push_back(&observer);
+            }
+            string mode = "Night";
+            while (state.keepRunning())
+            {
+                for (auto observer : observers)
+                {
+                    observer->update(mode);
+                }
+            }
+        }},
+        {"Task5/strategy", [](BenchmarkState& state)
+        {
+            unique_ptr<RenderStrategy> strategy(new Render2D());
+            while (state.keepRunning())
+            {
+                for (size_t i = 0; i < state.range(); ++i)
+                {
+                    strategy->render();
+                }
+            }
+        }},
+    };
+}
+void writeJson(const string& path, const vector<BenchmarkResult>& results, bool cacheMissesAvailable)
+{
+    ofstream out(path);
+    out << "{\n  \"context\": {\"library\": \"week4_benchmarks\", \"time_unit\": \"ns\", \"cache_misses_available\": " << (cacheMissesAvailable ? "true" : "false") << "},\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const auto& r = results[i];
+        out << "    {\"name\": \"" << r.name << "/" << r.range << "\", \"run_name\": \"" << r.name << "\", \"range\": " << r.range << ", \"iterations\": " << r.iterations << ", \"real_time\": " << r.nsPerOp << ", \"time_unit\": \"ns\", \"aggregate_name\": \"median\", \"allocs_per_iter\": " << r.allocationsPerOp << ", \"cache_misses_per_iter\": ";
+        if (cacheMissesAvailable)
+        {
+            out << r.cacheMissesPerOp;
+        }
+        else
+        {
+            out << "null";
+        }
+        out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+// One untimed warm-up iteration (first-touch page faults, allocator growth, cold caches), then
+// several repetitions of at least minIterations each; the median repetition is reported, so a single
+// stalled sample cannot become the result.
+BenchmarkResult measure(const BenchmarkCase& benchmark, size_t range, const CacheMissCounter& misses, streambuf* discard)
+{
+    constexpr int repetitions = 5;
+    constexpr uint64_t minIterations = 2;
+    constexpr double minTimeSeconds = 0.02;
+    streambuf* console = cout.rdbuf(discard);
+    BenchmarkState warmUp(range, misses, 0);
+    benchmark.body(warmUp);
+    vector<BenchmarkResult> runs;
+    uint64_t totalIterations = 0;
+    for (int r = 0; r < repetitions; ++r)
+    {
+        BenchmarkState state(range, misses, minTimeSeconds, minIterations);
+        benchmark.body(state);
+        runs.push_back({benchmark.name, range, state.iterationCount(), state.nsPerOp(), state.allocationsPerOp(), state.cacheMissesPerOp()});
+        totalIterations += state.iterationCount();
+    }
+    cout.rdbuf(console);
+    nth_element(runs.begin(), runs.begin() + repetitions / 2, runs.end(), [](const BenchmarkResult& a, const BenchmarkResult& b) { return a.nsPerOp < b.nsPerOp; });
+    BenchmarkResult median = runs[repetitions / 2];
+    median.iterations = totalIterations;
+    return median;
+}
+// Usage: week4_benchmarks [max_range (10..10000000, default 10000000)] [json_path] [name_filter]
+int main(int argc, char** argv)
+{
+    size_t maxRange = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+    string jsonPath = argc > 2 ? argv[2] : "week4_benchmarks.json";
+    string filter = argc > 3 ? argv[3] : "";
+    maxRange = min<size_t>(max<size_t>(maxRange, 10), 10000000);
+    vector<BenchmarkCase> cases;
+    for (auto group : {task1Cases(), task3Cases(), task4Cases(), task5Cases()})
+    {
+        cases.insert(cases.end(), group.begin(), group.end());
+    }
+    CacheMissCounter misses;
+    NullBuffer discard;
+    vector<BenchmarkResult> results;
+    cout << left << setw(36) << "Benchmark" << right << setw(9) << "Range" << setw(16) << "ns/op" << setw(12) << "allocs/op" << setw(12) << "misses/op" << "\n";
+    for (const auto& benchmark : cases)
+    {
+        if (benchmark.name.find(filter) == string::npos)
+        {
+            continue;
+        }
+        for (size_t range = 10; range <= maxRange; range *= 10)
+        {
+            BenchmarkResult result = measure(benchmark, range, misses, &discard);
+            results.push_back(result);
+            cout << left << setw(36) << benchmark.name << right << setw(9) << range << fixed << setprecision(1) << setw(16) << result.nsPerOp << setprecision(2) << setw(12) << result.allocationsPerOp;
+            if (misses.available())
+            {
+                cout << setw(12) << result.cacheMissesPerOp << "\n";
+            }
+            else
+            {
+                cout << setw(12) << "n/a" << "\n";
+            }
+        }
+    }
+    writeJson(jsonPath, results, misses.available());
+    cout << "Results written to " << jsonPath;
+    return 0;
+}
+Output:
+Benchmark                               Range           ns/op   allocs/op   misses/op
+Task1/for_each                             10            47.7        0.00         n/a
+Task1/for_each                            100           103.7        0.00         n/a
+Task1/for_each                           1000           860.0        0.00         n/a
+Task1/for_each                          10000          8522.9        0.00         n/a
+Task1/for_each                         100000        453480.7        0.00         n/a
+Task1/for_each                        1000000       9082804.0        0.00         n/a
+Task1/for_each                       10000000      86083492.5        0.00         n/a
+Task1/find_if                              10            55.4        0.00         n/a
+Task1/find_if                             100            96.2        0.00         n/a
+Task1/find_if                            1000           744.4        0.00         n/a
+Task1/find_if                           10000          6791.3        0.00         n/a
+Task1/find_if                          100000        376345.1        0.00         n/a
+Task1/find_if                         1000000       7604843.0        0.00         n/a
+Task1/find_if                        10000000      74337487.5        0.00         n/a
+Task1/adjacent_find                        10            58.6        0.00         n/a
+Task1/adjacent_find                       100           133.5        0.00         n/a
+Task1/adjacent_find                      1000           944.0        0.00         n/a
+Task1/adjacent_find                     10000          8555.4        0.00         n/a
+Task1/adjacent_find                    100000        408397.5        0.00         n/a
+Task1/adjacent_find                   1000000       8306992.0        0.00         n/a
+Task1/adjacent_find                  10000000      85473920.0        0.00         n/a
+Task1/count_if                             10           119.3        0.00         n/a
+Task1/count_if                            100           828.3        0.00         n/a
+Task1/count_if                           1000          7590.5        0.00         n/a
+Task1/count_if                          10000         77898.8        0.00         n/a
+Task1/count_if                         100000        880906.3        0.00         n/a
+Task1/count_if                        1000000      12927058.5        0.00         n/a
+Task1/count_if                       10000000     122729448.0        0.00         n/a
+Task1/equal                                10           136.4        0.00         n/a
+Task1/equal                               100           980.3        0.00         n/a
+Task1/equal                              1000          9850.9        0.00         n/a
+Task1/equal                             10000         99224.1        0.00         n/a
+Task1/equal                            100000       1868210.5        0.00         n/a
+Task1/equal                           1000000      18080478.0        0.00         n/a
+Task1/equal                          10000000     165484314.0        0.00         n/a
+Task3/transform_remove_partition           10           558.6        0.00         n/a
+Task3/transform_remove_partition          100          5233.2        0.00         n/a
+Task3/transform_remove_partition         1000         50257.8        0.00         n/a
+Task3/transform_remove_partition        10000        494777.1        0.00         n/a
+Task3/transform_remove_partition       100000       4703673.4        0.00         n/a
+Task3/transform_remove_partition      1000000      52308772.5        0.00         n/a
+Task3/transform_remove_partition     10000000     526525574.0        0.00         n/a
+Task4/sort                                 10           782.8        0.00         n/a
+Task4/sort                                100         15289.9        0.00         n/a
+Task4/sort                               1000        301285.0        0.00         n/a
+Task4/sort                              10000       4043353.0        0.00         n/a
+Task4/sort                             100000      50821185.5        0.00         n/a
+Task4/sort                            1000000     667913985.5        0.00         n/a
+Task4/sort                           10000000    6942784105.5        0.00         n/a
+Task4/merge                                10           298.3        1.00         n/a
+Task4/merge                               100          2338.0        1.00         n/a
+Task4/merge                              1000         30082.9        1.00         n/a
+Task4/merge                             10000        359212.0        1.00         n/a
+Task4/merge                            100000       5586739.0        1.00         n/a
+Task4/merge                           1000000      91797523.0        1.00         n/a
+Task4/merge                          10000000    1220071199.5        1.00         n/a
+Task4/set_union_intersection               10          1411.0       13.00         n/a
+Task4/set_union_intersection              100         16132.1       89.00         n/a
+Task4/set_union_intersection             1000        318912.9      818.00         n/a
+Task4/set_union_intersection            10000       5297719.2     7934.00         n/a
+Task4/set_union_intersection           100000     114312926.0    78821.00         n/a
+Task4/set_union_intersection          1000000    2783584222.0   787106.00         n/a
+Task4/set_union_intersection         10000000   59658578114.0  7871709.00         n/a
+Task5/factory                              10           456.9       11.00         n/a
+Task5/factory                             100          7083.2      101.00         n/a
+Task5/factory                            1000         67670.4     1001.00         n/a
+Task5/factory                           10000        699222.7    10001.00         n/a
+Task5/factory                          100000       6529279.0   100001.00         n/a
+Task5/factory                         1000000      65799907.5  1000001.00         n/a
+Task5/factory                        10000000     611921591.5 10000001.00         n/a
+Task5/observer                             10          2396.0        0.00         n/a
+Task5/observer                            100         23234.6        0.00         n/a
+Task5/observer                           1000        235147.2        0.00         n/a
+Task5/observer                          10000       2245948.2        0.00         n/a
+Task5/observer                         100000      22329604.0        0.00         n/a
+Task5/observer                        1000000     236573828.5        0.00         n/a
+Task5/observer                       10000000    2279221742.0        0.00         n/a
+Task5/strategy                             10          1058.0        0.00         n/a
+Task5/strategy                            100          9911.7        0.00         n/a
+Task5/strategy                           1000         95078.0        0.00         n/a
+Task5/strategy                          10000        973567.4        0.00         n/a
+Task5/strategy                         100000      10143002.5        0.00         n/a
+Task5/strategy                        1000000     104354924.5        0.00         n/a
+Task5/strategy                       10000000    1031062702.5        0.00         n/a
\ No newline at end of file
@@ -19,23 +19,595 @@ Program:
 #include <string>
 #include <algorithm>
 #include <iterator>
+#include <cctype>
 #include <set>
+#include <array>
+#include <cstdint>
+#include <thread>
+#include <chrono>
+#include <unordered_map>
+#include <stdexcept>
+#include <type_traits>
 using namespace std;
+// Natural order compares digit runs by value, so "C2" < "C10".
+bool naturalLess(const string& a, const string& b)
+{
+    size_t i = 0;
+    size_t j = 0;
+    while (i < a.size() && j < b.size())
+    {
+        if (isdigit(static_cast<unsigned char>(a[i])) && isdigit(static_cast<unsigned char>(b[j])))
+        {
+            size_t iEnd = i;
+            size_t jEnd = j;
+            while (iEnd < a.size() && isdigit(static_cast<unsigned char>(a[iEnd])))
+            {
+                ++iEnd;
+            }
+            while (jEnd < b.size() && isdigit(static_cast<unsigned char>(b[jEnd])))
+            {
+                ++jEnd;
+            }
+            while (i + 1 < iEnd && a[i] == '0')
+            {
+                ++i;
+            }
+            while (j + 1 < jEnd && b[j] == '0')
+            {
+                ++j;
+            }
+            if (iEnd - i != jEnd - j)
+            {
+                return iEnd - i < jEnd - j;
+            }
+            int digits = a.compare(i, iEnd - i, b, j, jEnd - j);
+            if (digits != 0)
+            {
+                return digits < 0;
+            }
+            i = iEnd;
+            j = jEnd;
+        }
+        else
+        {
+            if (a[i] != b[j])
+            {
+                return a[i] < b[j];
+            }
+            ++i;
+            ++j;
+        }
+    }
+    return a.size() - i < b.size() - j;
+}
+// Controls compare by interned key. Controls not given a key by a ControlIdTable keep unassignedKey,
+// order among themselves by natural ID order, and sort after every keyed control.
 struct Control 
 {
+    static constexpr uint32_t unassignedKey = UINT32_MAX;
     string id;
     string type;
+    uint32_t key = unassignedKey;
     bool operator<(const Control& other) const 
     {
-        return id < other.id;  
+        if (key == unassignedKey && other.key == unassignedKey)
+        {
+            return naturalLess(id, other.id);
+        }
+        return key < other.key;  
+    }
+};
+enum class IdOrder 
+{
+    Lexicographic,
+    Natural
+};
+// Interns string IDs into dense integer keys whose order matches the chosen string order.
+// IDs are added first, rank() assigns keys once, and from then on every comparison is an integer one.
+// Adding a new ID after rank() marks the table unranked again; key lookups throw until rank() reruns.
+class ControlIdTable 
+{
+    private:
+        IdOrder order;
+        unordered_map<string, uint32_t> keys;
+        vector<string> ids;
+        bool ranked = false;
+        void requireRanked() const
+        {
+            if (!ranked)
+            {
+                throw logic_error("ControlIdTable::rank() must run after the last add() and before key lookups");
+            }
+        }
+    public:
+        explicit ControlIdTable(IdOrder idOrder = IdOrder::Natural) : order(idOrder) {}
+        void add(const string& id)
+        {
+            if (keys.emplace(id, Control::unassignedKey).second)
+            {
+                ids.push_back(id);
+                ranked = false;
+            }
+        }
+        void add(const vector<Control>& controls)
+        {
+            for (const auto& control : controls)
+            {
+                add(control.id);
+            }
+        }
+        void rank()
+        {
+            if (order == IdOrder::Natural)
+            {
+                sort(ids.begin(), ids.end(), naturalLess);
+            }
+            else
+            {
+                sort(ids.begin(), ids.end());
+            }
+            for (uint32_t key = 0; key < ids.size(); ++key)
+            {
+                keys[ids[key]] = key;
+            }
+            ranked = true;
+        }
+        uint32_t key(const string& id) const
+        {
+            requireRanked();
+            auto found = keys.find(id);
+            if (found == keys.end())
+            {
+                throw out_of_range("Unknown control ID: " + id);
+            }
+            return found->second;
+        }
+        const string& id(uint32_t key) const
+        {
+            requireRanked();
+            return ids.at(key);
+        }
+        size_t size() const
+        {
+            return ids.size();
+        }
+        void assignKeys(vector<Control>& controls) const
+        {
+            for (auto& control : controls)
+            {
+                control.key = key(control.id);
+            }
+        }
+        Control probe(const string& id) const
+        {
+            return Control{id, "", key(id)};
+        }
+};
+struct CatalogEntry 
+{
+    uint32_t key;
+    uint32_t control;
+    bool operator<(const CatalogEntry& other) const 
+    {
+        return key < other.key;
+    }
+};
+template <typename Work>
+void runParallel(unsigned threads, Work work)
+{
+    vector<thread> workers;
+    for (unsigned t = 1; t < threads; ++t)
+    {
+        workers.emplace_back(work, t);
+    }
+    work(0u);
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+}
+// Stable LSD radix sort, 8 bits per pass. Each thread histograms and scatters its own chunk, and
+// offsets are laid out digit-major/thread-minor, so the result is identical for any thread count.
+void parallelRadixSort(vector<CatalogEntry>& entries, unsigned threads)
+{
+    size_t n = entries.size();
+    threads = max(1u, min(threads, static_cast<unsigned>(n / 4096 + 1)));
+    vector<CatalogEntry> buffer(n);
+    vector<array<size_t, 256>> offsets(threads);
+    auto chunkBegin = [n, threads](unsigned t) { return n * t / threads; };
+    for (unsigned shift = 0; shift < 32; shift += 8)
+    {
+        runParallel(threads, [&](unsigned t)
+        {
+            offsets[t].fill(0);
+            for (size_t i = chunkBegin(t); i < chunkBegin(t + 1); ++i)
+            {
+                ++offsets[t][(entries[i].key >> shift) & 0xFF];
+            }
+        });
+        size_t running = 0;
+        bool singleDigit = false;
+        for (size_t digit = 0; digit < 256; ++digit)
+        {
+            size_t digitTotal = 0;
+            for (unsigned t = 0; t < threads; ++t)
+            {
+                size_t count = offsets[t][digit];
+                offsets[t][digit] = running;
+                running += count;
+                digitTotal += count;
+            }
+            singleDigit = singleDigit || digitTotal == n;
+        }
+        if (singleDigit)
+        {
+            continue;
+        }
+        runParallel(threads, [&](unsigned t)
+        {
+            auto& next = offsets[t];
+            for (size_t i = chunkBegin(t); i < chunkBegin(t + 1); ++i)
+            {
+                buffer[next[(entries[i].key >> shift) & 0xFF]++] = entries[i];
+            }
+        });
+        entries.swap(buffer);
+    }
+}
+void sortCatalogByKey(vector<Control>& controls, unsigned threads)
+{
+    vector<CatalogEntry> entries(controls.size());
+    for (size_t i = 0; i < controls.size(); ++i)
+    {
+        entries[i] = CatalogEntry{controls[i].key, static_cast<uint32_t>(i)};
+    }
+    parallelRadixSort(entries, threads);
+    vector<Control> sorted;
+    sorted.reserve(controls.size());
+    for (const auto& entry : entries)
+    {
+        sorted.push_back(move(controls[entry.control]));
+    }
+    controls.swap(sorted);
+    // Unkeyed controls all land at unassignedKey; order them by natural ID, as Control::operator< does.
+    auto unkeyed = partition_point(controls.begin(), controls.end(), [](const Control& control) { return control.key != Control::unassignedKey; });
+    stable_sort(unkeyed, controls.end(), [](const Control& a, const Control& b) { return naturalLess(a.id, b.id); });
+}
+// Merges sorted ranges in one pass with a loser tree: each output element costs one replay from its
+// leaf to the root, i.e. log2(runs) comparisons. Every node caches its loser's current element (a
+// copy for small trivially copyable T, a pointer otherwise), so a replay compares cached values and
+// touches the input only to advance the winning run. Equal elements keep run order.
+template <typename T, typename Less>
+void loserTreeMerge(const vector<pair<const T*, const T*>>& ranges, T* out, Less lessThan)
+{
+    using Cached = conditional_t<is_trivially_copyable_v<T> && sizeof(T) <= 16, T, const T*>;
+    auto value = [](const Cached& cached) -> const T&
+    {
+        if constexpr (is_pointer_v<Cached>)
+        {
+            return *cached;
+        }
+        else
+        {
+            return cached;
+        }
+    };
+    struct Entry
+    {
+        Cached cached;
+        uint32_t run;
+        bool done;
+    };
+    size_t leaves = 1;
+    while (leaves < ranges.size())
+    {
+        leaves <<= 1;
+    }
+    vector<const T*> head(leaves, nullptr);
+    vector<const T*> tail(leaves, nullptr);
+    auto load = [&](uint32_t run)
+    {
+        Entry entry{Cached(), run, head[run] == tail[run]};
+        if (!entry.done)
+        {
+            if constexpr (is_pointer_v<Cached>)
+            {
+                entry.cached = head[run];
+            }
+            else
+            {
+                entry.cached = *head[run];
+            }
+        }
+        return entry;
+    };
+    auto beats = [&](const Entry& a, const Entry& b)
+    {
+        if (a.done || b.done)
+        {
+            return !a.done;
+        }
+        if (lessThan(value(a.cached), value(b.cached)))
+        {
+            return true;
+        }
+        return a.run < b.run && !lessThan(value(b.cached), value(a.cached));
+    };
+    for (size_t r = 0; r < ranges.size(); ++r)
+    {
+        head[r] = ranges[r].first;
+        tail[r] = ranges[r].second;
+    }
+    vector<Entry> winners(2 * leaves);
+    for (uint32_t leaf = 0; leaf < leaves; ++leaf)
+    {
+        winners[leaves + leaf] = load(leaf);
     }
+    vector<Entry> losers(leaves);
+    for (size_t node = leaves - 1; node >= 1; --node)
+    {
+        const Entry& a = winners[2 * node];
+        const Entry& b = winners[2 * node + 1];
+        bool aWins = beats(a, b);
+        winners[node] = aWins ? a : b;
+        losers[node] = aWins ? b : a;
+    }
+    Entry winner = winners[1];
+    while (!winner.done)
+    {
+        *out++ = value(winner.cached);
+        ++head[winner.run];
+        size_t node = (winner.run + leaves) / 2;
+        winner = load(winner.run);
+        for (; node >= 1; node /= 2)
+        {
+            if (beats(losers[node], winner))
+            {
+                swap(losers[node], winner);
+            }
+        }
+    }
+}
+// k-way merge of sorted runs, matching a chain of pairwise std::merge calls. With several threads
+// the output is cut at sampled splitter values: each run is split at lower_bound(splitter), so
+// elements equal to a splitter all fall in the same part, and each part is merged by its own loser
+// tree straight into its slice of the result. The result is identical for any thread count.
+template <typename T, typename Less = less<T>>
+vector<T> kWayMerge(const vector<vector<T>>& runs, unsigned threads = 1, Less lessThan = Less())
+{
+    size_t total = 0;
+    for (const auto& run : runs)
+    {
+        total += run.size();
+    }
+    threads = max(1u, min(threads, static_cast<unsigned>(total / 65536 + 1)));
+    vector<T> samples;
+    for (const auto& run : runs)
+    {
+        size_t perRun = min<size_t>(run.size(), 8 * threads);
+        for (size_t i = 0; i < perRun; ++i)
+        {
+            samples.push_back(run[run.size() * i / perRun]);
+        }
+    }
+    sort(samples.begin(), samples.end(), lessThan);
+    vector<vector<pair<const T*, const T*>>> parts(threads);
+    vector<size_t> offsets(threads + 1, 0);
+    for (size_t r = 0; r < runs.size(); ++r)
+    {
+        const T* cut = runs[r].data();
+        for (unsigned t = 0; t < threads; ++t)
+        {
+            const T* next = runs[r].data() + runs[r].size();
+            if (t + 1 < threads)
+            {
+                next = lower_bound(cut, next, samples[samples.size() * (t + 1) / threads], lessThan);
+            }
+            parts[t].emplace_back(cut, next);
+            offsets[t + 1] += static_cast<size_t>(next - cut);
+            cut = next;
+        }
+    }
+    for (unsigned t = 0; t < threads; ++t)
+    {
+        offsets[t + 1] += offsets[t];
+    }
+    vector<T> merged(total);
+    runParallel(threads, [&](unsigned t) { loserTreeMerge(parts[t], merged.data() + offsets[t], lessThan); });
+    return merged;
+}
+template <typename Work>
+double elapsedMs(Work work)
+{
+    auto start = chrono::steady_clock::now();
+    work();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+void benchmarkCatalogs(size_t catalogCount, size_t entriesPerCatalog)
+{
+    vector<vector<CatalogEntry>> catalogs(catalogCount);
+    uint32_t seed = 12345;
+    for (auto& catalog : catalogs)
+    {
+        for (size_t i = 0; i < entriesPerCatalog; ++i)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            catalog.push_back(CatalogEntry{seed >> 8, static_cast<uint32_t>(i)});
+        }
+    }
+    cout << "\nSorting " << catalogCount << " catalogs of " << entriesPerCatalog << " entries: std::sort ";
+    auto work = catalogs;
+    cout << elapsedMs([&]() { for (auto& c : work) sort(c.begin(), c.end()); }) << " ms";
+    for (unsigned threads : {1u, 4u, 16u})
+    {
+        auto radix = catalogs;
+        cout << ", radix x" << threads << " " << elapsedMs([&]() { for (auto& c : radix) parallelRadixSort(c, threads); }) << " ms";
+    }
+    vector<CatalogEntry> chained;
+    double chainMs = elapsedMs([&]()
+    {
+        for (const auto& catalog : work)
+        {
+            vector<CatalogEntry> next(chained.size() + catalog.size());
+            merge(chained.begin(), chained.end(), catalog.begin(), catalog.end(), next.begin());
+            chained.swap(next);
+        }
+    });
+    cout << "\nMerging them: pairwise merge chain " << chainMs << " ms, k-way loser-tree merge";
+    bool identical = true;
+    double singleMs = 0;
+    for (unsigned threads : {1u, 4u, 16u})
+    {
+        vector<CatalogEntry> kWay;
+        double ms = elapsedMs([&]() { kWay = kWayMerge(work, threads); });
+        singleMs = threads == 1 ? ms : singleMs;
+        cout << " x" << threads << " " << ms << " ms";
+        identical = identical && equal(kWay.begin(), kWay.end(), chained.begin(), chained.end(), [](const CatalogEntry& a, const CatalogEntry& b) { return a.key == b.key && a.control == b.control; });
+    }
+    // The chain re-copies everything merged so far for each catalog, so the k-way merge only pays
+    // off as the catalog count grows; with few catalogs it can lose.
+    cout << "\n  single-thread k-way vs chain: " << chainMs / singleMs << "x, matches chain: " << (identical ? "Yes" : "No") << ", " << thread::hardware_concurrency() << " hardware threads";
+}
+// Membership over interned control keys, one bit per key. Set algebra and counting run a
+// 64-bit word at a time in plain loops the compiler can vectorize.
+class ControlSet 
+{
+    private:
+        vector<uint64_t> words;
+    public:
+        explicit ControlSet(size_t universe = 0) : words((universe + 63) / 64, 0) {}
+        ControlSet(const vector<Control>& controls, size_t universe) : ControlSet(universe)
+        {
+            for (const auto& control : controls)
+            {
+                if (control.key == Control::unassignedKey)
+                {
+                    throw invalid_argument("Control has no interned key: " + control.id);
+                }
+                insert(control.key);
+            }
+        }
+        void insert(uint32_t key)
+        {
+            if (key / 64 >= words.size())
+            {
+                words.resize(key / 64 + 1, 0);
+            }
+            words[key / 64] |= uint64_t(1) << (key % 64);
+        }
+        bool contains(uint32_t key) const
+        {
+            return key / 64 < words.size() && ((words[key / 64] >> (key % 64)) & 1);
+        }
+        size_t count() const
+        {
+            size_t total = 0;
+            for (uint64_t word : words)
+            {
+                total += __builtin_popcountll(word);
+            }
+            return total;
+        }
+        ControlSet& operator|=(const ControlSet& other)
+        {
+            if (other.words.size() > words.size())
+            {
+                words.resize(other.words.size(), 0);
+            }
+            for (size_t w = 0; w < other.words.size(); ++w)
+            {
+                words[w] |= other.words[w];
+            }
+            return *this;
+        }
+        ControlSet& operator&=(const ControlSet& other)
+        {
+            words.resize(min(words.size(), other.words.size()));
+            for (size_t w = 0; w < words.size(); ++w)
+            {
+                words[w] &= other.words[w];
+            }
+            return *this;
+        }
+        ControlSet& operator-=(const ControlSet& other)
+        {
+            size_t common = min(words.size(), other.words.size());
+            for (size_t w = 0; w < common; ++w)
+            {
+                words[w] &= ~other.words[w];
+            }
+            return *this;
+        }
+        friend ControlSet operator|(ControlSet a, const ControlSet& b)
+        {
+            return a |= b;
+        }
+        friend ControlSet operator&(ControlSet a, const ControlSet& b)
+        {
+            return a &= b;
+        }
+        friend ControlSet operator-(ControlSet a, const ControlSet& b)
+        {
+            return a -= b;
+        }
+        // Visits member keys in ascending order.
+        template <typename Visitor>
+        void forEach(Visitor visit) const
+        {
+            for (size_t w = 0; w < words.size(); ++w)
+            {
+                for (uint64_t bits = words[w]; bits != 0; bits &= bits - 1)
+                {
+                    visit(static_cast<uint32_t>(w * 64 + __builtin_ctzll(bits)));
+                }
+            }
+        }
 };
+void printControlSet(const ControlSet& controls, const ControlIdTable& idTable)
+{
+    controls.forEach([&idTable](uint32_t key)
+    {
+        cout << idTable.id(key) << " ";
+    });
+}
+void benchmarkProfileSwitch(size_t universe, size_t profileSize)
+{
+    vector<Control> profileA;
+    vector<Control> profileB;
+    for (size_t i = 0; i < profileSize; ++i)
+    {
+        profileA.push_back(Control{"", "", static_cast<uint32_t>((i * 7) % universe)});
+        profileB.push_back(Control{"", "", static_cast<uint32_t>((i * 11) % universe)});
+    }
+    size_t treeCommon = 0;
+    double treeMs = elapsedMs([&]()
+    {
+        set<Control> a(profileA.begin(), profileA.end());
+        set<Control> b(profileB.begin(), profileB.end());
+        vector<Control> common;
+        set_intersection(a.begin(), a.end(), b.begin(), b.end(), back_inserter(common));
+        treeCommon = common.size();
+    });
+    size_t bitsetCommon = 0;
+    double bitsetMs = elapsedMs([&]()
+    {
+        bitsetCommon = (ControlSet(profileA, universe) & ControlSet(profileB, universe)).count();
+    });
+    cout << "\nProfile switch (" << profileSize << " of " << universe << " controls, " << bitsetCommon << " common): std::set + set_intersection " << treeMs << " ms, ControlSet " << bitsetMs << " ms" << (treeCommon == bitsetCommon ? "" : " (mismatch)");
+}
 int main() 
 {
     vector<Control> controls1 = { {"C5", "Slider"}, {"C2", "Button"}, {"C3", "Slider"}, {"C4", "Button"} };
     vector<Control> controls2 = { {"C1", "Button"}, {"C3", "Slider"}, {"C6", "Button"}, {"C7", "Slider"} };
-    sort(controls1.begin(), controls1.end());
-    sort(controls2.begin(), controls2.end());
+    ControlIdTable idTable;
+    idTable.add(controls1);
+    idTable.add(controls2);
+    idTable.rank();
+    idTable.assignKeys(controls1);
+    idTable.assignKeys(controls2);
+    unsigned threads = max(1u, thread::hardware_concurrency());
+    sortCatalogByKey(controls1, threads);
+    sortCatalogByKey(controls2, threads);
     cout << "Sorted controls1: ";
     for (const auto& control : controls1) 
     {
@@ -46,13 +618,12 @@ int main()
     {
         cout << control.id << " ";
     }
-    stable_sort(controls1.begin(), controls1.end());
-    cout << "\nAfter stable sort (controls1): ";
+    cout << "\nAfter stable radix sort by key (controls1): ";
     for (const auto& control : controls1) 
     {
         cout << control.id << " ";
     }
-    auto it = lower_bound(controls1.begin(), controls1.end(), Control{"C3", ""});
+    auto it = lower_bound(controls1.begin(), controls1.end(), idTable.probe("C3"));
     if (it != controls1.end()) 
     {
         cout << "\nFound control with ID C3 at position: " << distance(controls1.begin(), it);
@@ -61,7 +632,7 @@ int main()
     {
         cout << "\nControl with ID C3 not found!";
     }
-    it = upper_bound(controls1.begin(), controls1.end(), Control{"C3", ""});
+    it = upper_bound(controls1.begin(), controls1.end(), idTable.probe("C3"));
     if (it != controls1.end()) 
     {
         cout << "\nUpper bound for ID C3 is control with ID: " << it->id;
@@ -70,8 +641,7 @@ int main()
     {
         cout << "\nNo control greater than C3 found!";
     }
-    vector<Control> mergedControls(controls1.size() + controls2.size());
-    merge(controls1.begin(), controls1.end(), controls2.begin(), controls2.end(), mergedControls.begin());
+    vector<Control> mergedControls = kWayMerge(vector<vector<Control>>{controls1, controls2});
     cout << "\nMerged controls: ";
     for (const auto& control : mergedControls) 
     {
@@ -84,30 +654,47 @@ int main()
     {
         cout << control.id << " ";
     }
-    set<Control> set1(controls1.begin(), controls1.end());
-    set<Control> set2(controls2.begin(), controls2.end());
-    vector<Control> unionControls;
-    set_union(set1.begin(), set1.end(), set2.begin(), set2.end(), back_inserter(unionControls));
+    size_t universe = idTable.size();
+    ControlSet set1(controls1, universe);
+    ControlSet set2(controls2, universe);
     cout << "\nUnion of controls (unique controls from both lists): ";
-    for (const auto& control : unionControls) 
-    {
-        cout << control.id << " ";
-    }
-    vector<Control> intersectionControls;
-    set_intersection(set1.begin(), set1.end(), set2.begin(), set2.end(), back_inserter(intersectionControls));
+    printControlSet(set1 | set2, idTable);
     cout << "\nIntersection of controls (common controls): ";
-    for (const auto& control : intersectionControls) 
+    printControlSet(set1 & set2, idTable);
+    cout << "\nDifference of controls (only in controls1): ";
+    printControlSet(set1 - set2, idTable);
+    ControlIdTable lexicographic(IdOrder::Lexicographic);
+    ControlIdTable natural(IdOrder::Natural);
+    for (const char* id : {"C10", "C2", "C1"})
     {
-        cout << control.id << " ";
+        lexicographic.add(id);
+        natural.add(id);
     }
+    lexicographic.rank();
+    natural.rank();
+    cout << "\nLexicographic key order: " << lexicographic.id(0) << " " << lexicographic.id(1) << " " << lexicographic.id(2);
+    cout << "\nNatural key order: " << natural.id(0) << " " << natural.id(1) << " " << natural.id(2);
+    benchmarkCatalogs(20, 100000);
+    benchmarkCatalogs(200, 10000);
+    benchmarkProfileSwitch(100000, 50000);
     return 0;
 }
 Output:
 Sorted controls1: C2 C3 C4 C5 Sorted controls2: C1 C3 C6 C7 
-After stable sort (controls1): C2 C3 C4 C5 
+After stable radix sort by key (controls1): C2 C3 C4 C5 
 Found control with ID C3 at position: 1
 Upper bound for ID C3 is control with ID: C4
 Merged controls: C1 C2 C3 C3 C4 C5 C6 C7 
 In-place merged controls1: C1 C2 C3 C3 C4 C5 C6 C7 
 Union of controls (unique controls from both lists): C1 C2 C3 C4 C5 C6 C7 
-Intersection of controls (common controls): C1 C3 C6 C7
\ No newline at end of file
+Intersection of controls (common controls): C1 C3 C6 C7 
+Difference of controls (only in controls1): C2 C4 C5 
+Lexicographic key order: C1 C10 C2
+Natural key order: C1 C2 C10
+Sorting 20 catalogs of 100000 entries: std::sort 229.133 ms, radix x1 82.2292 ms, radix x4 83.311 ms, radix x16 187.879 ms
+Merging them: pairwise merge chain 146.553 ms, k-way loser-tree merge x1 121.597 ms x4 132.976 ms x16 126.171 ms
+  single-thread k-way vs chain: 1.20523x, matches chain: Yes, 1 hardware threads
+Sorting 200 catalogs of 10000 entries: std::sort 175.383 ms, radix x1 64.735 ms, radix x4 127.599 ms, radix x16 108.352 ms
+Merging them: pairwise merge chain 800.832 ms, k-way loser-tree merge x1 209.592 ms x4 189.722 ms x16 197.396 ms
+  single-thread k-way vs chain: 3.82092x, matches chain: Yes, 1 hardware threads
+Profile switch (50000 of 100000 controls, 25324 common): std::set + set_intersection 24.4085 ms, ControlSet 3.11989 ms
\ No newline at end of file